@@ -0,0 +1,87 @@
+// This may look like C code, but it's really -*- C++ -*-
+/*
+ * Copyright (C) 2012 Emweb bvba, Kessel-Lo, Belgium.
+ *
+ * See the LICENSE file for terms of use.
+ */
+#ifndef WT_DBO_BULK_INSERTER_IMPL_H_
+#define WT_DBO_BULK_INSERTER_IMPL_H_
+
+#include <exception>
+#include <iostream>
+
+namespace Wt {
+  namespace Dbo {
+
+template <class C>
+BulkInserter<C>::BulkInserter(Session& session)
+  : session_(session),
+    mapping_(session.getMapping<C>()),
+    statement_(0),
+    finished_(false),
+    count_(0)
+{
+  session_.flush();
+  session_.noteWrite();
+
+  statement_ = session_.startBulkInsert(mapping_);
+}
+
+template <class C>
+BulkInserter<C>::~BulkInserter()
+{
+  if (!finished_) {
+    try {
+      end(!std::uncaught_exception());
+    } catch (const std::exception& e) {
+      std::cerr << "BulkInserter::~BulkInserter(): " << e.what() << std::endl;
+    } catch (...) {
+      std::cerr << "BulkInserter::~BulkInserter(): unknown error" << std::endl;
+    }
+  }
+}
+
+template <class C>
+void BulkInserter<C>::insert(C& obj)
+{
+  if (finished_)
+    throw Exception("BulkInserter::insert(): bulk insert was finished");
+
+  /*
+   * Without support for bulk inserts, each object is inserted
+   * using the insert statement of the session.
+   */
+  SqlStatement *statement = statement_;
+  ScopedStatementUse use;
+
+  if (!statement)
+    use(statement = session_.getStatement<C>(Session::SqlInsert));
+
+  BulkInsertAction<C> action(session_, *mapping_, statement);
+  action.visit(obj);
+
+  ++count_;
+}
+
+template <class C>
+void BulkInserter<C>::finish()
+{
+  if (!finished_)
+    end(true);
+}
+
+template <class C>
+void BulkInserter<C>::end(bool success)
+{
+  SqlStatement *statement = statement_;
+  statement_ = 0;
+  finished_ = true;
+
+  if (statement)
+    session_.endBulkInsert(statement, success);
+}
+
+  }
+}
+
+#endif // WT_DBO_BULK_INSERTER_IMPL_H_
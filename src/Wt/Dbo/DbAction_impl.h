@@ -445,6 +445,41 @@ void SaveDbAction<C>::visit(C& obj)
   }
 }
 
+template<class C>
+void SaveDbAction<C>::visitDependencies(C& obj)
+{
+  startDependencyPass();
+
+  persist<C>::apply(obj, *this);
+}
+
+template<class C>
+void SaveDbAction<C>::bindInsert(C& obj, SqlStatement *statement, int& column)
+{
+  pass_ = Self;
+  needSetsPass_ = false;
+  isInsert_ = true;
+
+  statement_ = statement;
+  column_ = column;
+
+  if (mapping().versionFieldName)
+    statement_->bind(column_++, dbo_.version() + 1);
+
+  persist<C>::apply(obj, *this);
+
+  column = column_;
+}
+
+template<class C>
+void SaveDbAction<C>::visitSets(C& obj)
+{
+  if (!mapping().sets.empty()) {
+    startSetsPass();
+    persist<C>::apply(obj, *this);
+  }
+}
+
 template<class C>
 template<typename V>
 void SaveDbAction<C>::actId(V& value, const std::string& name, int size)
@@ -468,6 +503,51 @@ void SaveDbAction<C>::actId(ptr<D>& value, const std::string& name, int size,
     dbo_.setId(value);
 }
 
+    /*
+     * BulkInsertAction
+     */
+
+template <class C>
+BulkInsertAction<C>::BulkInsertAction(Session& session,
+				      Session::Mapping<C>& mapping,
+				      SqlStatement *statement)
+  : SaveBaseAction(&session, statement, 0),
+    mapping_(mapping)
+{ }
+
+template<class C>
+void BulkInsertAction<C>::visit(C& obj)
+{
+  pass_ = Self;
+  needSetsPass_ = false;
+  isInsert_ = true;
+
+  statement_->reset();
+  column_ = 0;
+
+  if (mapping_.versionFieldName)
+    statement_->bind(column_++, 0);
+
+  persist<C>::apply(obj, *this);
+
+  statement_->execute();
+}
+
+template<class C>
+template<typename V>
+void BulkInsertAction<C>::actId(V& value, const std::string& name, int size)
+{
+  field(*this, value, name, size);
+}
+
+template<class C>
+template<class D>
+void BulkInsertAction<C>::actId(ptr<D>& value, const std::string& name,
+				int size, int fkConstraints)
+{
+  actPtr(PtrRef<D>(value, name, size, fkConstraints));
+}
+
 
     /*
      * TransactionDoneAction
@@ -476,6 +556,12 @@ void SaveDbAction<C>::actId(ptr<D>& value, const std::string& name, int size,
 template<class C>
 void TransactionDoneAction::visit(C& obj)
 {
+  /*
+   * The object was saved or deleted: a snapshot in a shared cache is
+   * outdated, or (after a rollback) may contain uncommitted changes.
+   */
+  session_.uncache(static_cast<MetaDbo<C>&>(dbo()));
+
   persist<C>::apply(obj, *this);
 }
 
@@ -8,6 +8,7 @@
 #define WT_DBO_QUERY_MODEL_IMPL_H_
 
 #include <Wt/Dbo/QueryColumn>
+#include <Wt/Dbo/WtSqlTraits>
 
 namespace Wt {
   namespace Dbo {
@@ -16,8 +17,12 @@ template <class Result>
 QueryModel<Result>::QueryModel(WObject *parent)
   : WAbstractTableModel(parent),
     batchSize_(40),
+    sortFieldIdx_(-1),
+    sortOrder_(AscendingOrder),
+    estimatedRowCount_(-1),
     cachedRowCount_(-1),
     cacheStart_(-1),
+    resultsEnd_(-1),
     currentRow_(-1)
 { }
 
@@ -32,6 +37,7 @@ void QueryModel<Result>::setQuery(const Query<Result>& query,
     query_ = query;
     fields_ = query_.fields();
     columns_.clear();
+    sortFieldIdx_ = -1;
     reset();
   } else {
     invalidateData();
@@ -47,6 +53,27 @@ void QueryModel<Result>::setBatchSize(int count)
   batchSize_ = count;
 }
 
+template <class Result>
+void QueryModel<Result>::setKeysetPagination(const std::string& keyField)
+{
+  invalidateData();
+  keyField_ = keyField;
+
+  if (keyField_.empty() && sortFieldIdx_ != -1)
+    query_.orderBy(fields_[sortFieldIdx_].sql() + " "
+		   + (sortOrder_ == AscendingOrder ? "asc" : "desc"));
+
+  dataReloaded();
+}
+
+template <class Result>
+void QueryModel<Result>::setEstimatedRowCount(int count)
+{
+  invalidateData();
+  estimatedRowCount_ = count;
+  dataReloaded();
+}
+
 template <class Result>
 int QueryModel<Result>::addColumn(const std::string& field,
 				  const WString& header,
@@ -102,6 +129,9 @@ int QueryModel<Result>::rowCount(const WModelIndex& parent) const
   if (parent.isValid())
     return 0;
 
+  if (estimatedRowCount_ >= 0)
+    return estimatedRowCount_;
+
   if (cachedRowCount_ == -1) {
     Transaction transaction(query_.session());
 
@@ -126,6 +156,10 @@ boost::any QueryModel<Result>::data(const WModelIndex& index, int role) const
 {
   setCurrentRow(index.row());
 
+  if (estimatedRowCount_ >= 0 && resultsEnd_ != -1
+      && index.row() >= resultsEnd_)
+    return boost::any();
+
   if (role == DisplayRole || role == EditRole)
     return rowValues_[columns_[index.column()].fieldIdx_];
   else
@@ -177,11 +211,13 @@ bool QueryModel<Result>::setData(const WModelIndex& index,
 template <class Result>
 void QueryModel<Result>::invalidateData()
 {
+  flushBatch();
   layoutAboutToBeChanged().emit();
 
-  cachedRowCount_ = cacheStart_ = currentRow_ = -1;
+  cachedRowCount_ = cacheStart_ = currentRow_ = resultsEnd_ = -1;
   cache_.clear();
   rowValues_.clear();
+  keysetBoundaries_.clear();
 }
 
 template <class Result>
@@ -200,8 +236,15 @@ void QueryModel<Result>::sort(int column, SortOrder order)
 
   invalidateData();
 
-  query_.orderBy(fields_[columns_[column].fieldIdx_].sql() + " "
-		 + (order == AscendingOrder ? "asc" : "desc"));
+  sortFieldIdx_ = columns_[column].fieldIdx_;
+  sortOrder_ = order;
+
+  /*
+   * With keyset pagination, the order is set on each batch query
+   */
+  if (keyField_.empty())
+    query_.orderBy(fields_[sortFieldIdx_].sql() + " "
+		   + (order == AscendingOrder ? "asc" : "desc"));
 
   cachedRowCount_ = rc;
   dataReloaded();
@@ -212,26 +255,53 @@ Result& QueryModel<Result>::resultRow(int row)
 {
   if (row < cacheStart_
       || row >= cacheStart_ + static_cast<int>(cache_.size())) {
-    cacheStart_ = std::max(row - batchSize_ / 4, 0);
+    /*
+     * With an estimated row count, rows beyond the end of the results
+     * are empty.
+     */
+    if (estimatedRowCount_ >= 0 && resultsEnd_ != -1 && row >= resultsEnd_) {
+      noResult_ = Result();
+      return noResult_;
+    }
 
-    int qOffset = cacheStart_;
-    if (queryOffset_ > 0)
-      qOffset += queryOffset_;
-    query_.offset(qOffset);
+    cacheStart_ = std::max(row - batchSize_ / 4, 0);
 
     int qLimit = batchSize_;
     if (queryLimit_ > 0)
       qLimit = std::min(batchSize_, queryLimit_ - cacheStart_);
-    query_.limit(qLimit);
 
     Transaction transaction(query_.session());
 
-    collection<Result> results = query_.resultList();
+    collection<Result> results;
+    if (keyField_.empty()) {
+      int qOffset = cacheStart_;
+      if (queryOffset_ > 0)
+	qOffset += queryOffset_;
+      query_.offset(qOffset);
+      query_.limit(qLimit);
+
+      results = query_.resultList();
+    } else
+      results = keysetResultList(qLimit);
+
     cache_.clear();
     cache_.insert(cache_.end(), results.begin(), results.end());   
 
-    if (row >= cacheStart_ + static_cast<int>(cache_.size()))
-      throw Exception("QueryModel: geometry inconsistent with database");
+    if (static_cast<int>(cache_.size()) < qLimit)
+      resultsEnd_ = cacheStart_ + static_cast<int>(cache_.size());
+
+    if (!keyField_.empty())
+      addKeysetBoundaries();
+
+    if (row >= cacheStart_ + static_cast<int>(cache_.size())) {
+      if (estimatedRowCount_ < 0)
+	throw Exception("QueryModel: geometry inconsistent with database");
+
+      transaction.commit();
+
+      noResult_ = Result();
+      return noResult_;
+    }
 
     transaction.commit();
   }
@@ -239,6 +309,154 @@ Result& QueryModel<Result>::resultRow(int row)
   return cache_[row - cacheStart_];
 }
 
+template <class Result>
+collection<Result> QueryModel<Result>::keysetResultList(int limit)
+{
+  int keyIdx = getFieldIndex(keyField_);
+  bool sorted = sortFieldIdx_ != -1 && sortFieldIdx_ != keyIdx;
+  bool ascending = sortFieldIdx_ == -1 || sortOrder_ == AscendingOrder;
+
+  const std::string& keySql = fields_[keyIdx].sql();
+  std::string direction = ascending ? " asc" : " desc";
+  std::string op = ascending ? " > ?" : " < ?";
+
+  /*
+   * The order of the query is replaced, and thus may not have bound
+   * parameters.
+   */
+  if (Impl::countParameters(query_.orderBy_) != 0)
+    throw Exception("QueryModel: keyset pagination replaces an order by "
+		    "with bound parameters");
+
+  Query<Result> query = query_;
+
+  if (sorted)
+    query.orderBy(fields_[sortFieldIdx_].sql() + direction
+		  + ", " + keySql + direction);
+  else
+    query.orderBy(keySql + direction);
+
+  /*
+   * Continue after the last known row before the batch, and skip
+   * the (few) rows in between.
+   */
+  typename AnyListMap::const_iterator b
+    = keysetBoundaries_.lower_bound(cacheStart_);
+
+  int offset;
+  if (b != keysetBoundaries_.begin()) {
+    --b;
+    const AnyList& key = b->second;
+
+    if (sorted) {
+      const std::string& sortSql = fields_[sortFieldIdx_].sql();
+      query.where(sortSql + op + " or (" + sortSql + " = ? and "
+		  + keySql + op + ")");
+      bindKey(query, key[0]);
+      bindKey(query, key[0]);
+      bindKey(query, key[1]);
+      query.moveToWhere(3);
+    } else {
+      query.where(keySql + op);
+      bindKey(query, key[0]);
+      query.moveToWhere(1);
+    }
+
+    offset = cacheStart_ - static_cast<int>(b->first) - 1;
+  } else {
+    offset = cacheStart_;
+    if (queryOffset_ > 0)
+      offset += queryOffset_;
+  }
+
+  query.offset(offset > 0 ? offset : -1);
+  query.limit(limit);
+
+  return query.resultList();
+}
+
+template <class Result>
+void QueryModel<Result>::addKeysetBoundaries()
+{
+  int keyIdx = getFieldIndex(keyField_);
+  bool sorted = sortFieldIdx_ != -1 && sortFieldIdx_ != keyIdx;
+
+  /*
+   * A batch starts a quarter batch before the requested row: we keep
+   * the key of every quarter batch, so that the next batch needs an
+   * offset of less than a quarter batch.
+   */
+  int step = std::max(batchSize_ / 4, 1);
+
+  for (unsigned i = 0; i < cache_.size(); ++i) {
+    int row = cacheStart_ + static_cast<int>(i);
+
+    if ((row + 1) % step != 0 && i != cache_.size() - 1)
+      continue;
+
+    AnyList values;
+    query_result_traits<Result>::getValues(cache_[i], values);
+
+    AnyList key;
+    if (sorted)
+      key.push_back(values[sortFieldIdx_]);
+    key.push_back(values[keyIdx]);
+
+    bool valid = true;
+    for (unsigned j = 0; j < key.size(); ++j)
+      if (!isKeyValue(key[j]))
+	valid = false;
+
+    if (valid)
+      keysetBoundaries_[row] = key;
+  }
+}
+
+template <class Result>
+bool QueryModel<Result>::isKeyValue(const boost::any& value)
+{
+  const std::type_info& t = value.type();
+
+  return t == typeid(long long) || t == typeid(int) || t == typeid(long)
+    || t == typeid(short) || t == typeid(bool) || t == typeid(float)
+    || t == typeid(double) || t == typeid(std::string)
+    || t == typeid(WString) || t == typeid(WDate) || t == typeid(WDateTime)
+    || t == typeid(WTime) || t == typeid(boost::posix_time::ptime)
+    || t == typeid(boost::posix_time::time_duration);
+}
+
+template <class Result>
+void QueryModel<Result>::bindKey(Query<Result>& query,
+				 const boost::any& value)
+{
+  const std::type_info& t = value.type();
+
+#define BIND_KEY(T)				\
+  if (t == typeid(T)) {				\
+    query.bind(boost::any_cast<T>(value));	\
+    return;					\
+  }
+
+  BIND_KEY(long long)
+  BIND_KEY(int)
+  BIND_KEY(long)
+  BIND_KEY(short)
+  BIND_KEY(bool)
+  BIND_KEY(float)
+  BIND_KEY(double)
+  BIND_KEY(std::string)
+  BIND_KEY(WString)
+  BIND_KEY(WDate)
+  BIND_KEY(WDateTime)
+  BIND_KEY(WTime)
+  BIND_KEY(boost::posix_time::ptime)
+  BIND_KEY(boost::posix_time::time_duration)
+
+#undef BIND_KEY
+
+  throw Exception("QueryModel: unsupported key type for keyset pagination");
+}
+
 template <class Result>
 void QueryModel<Result>::invalidateRow(int row)
 {
@@ -247,7 +465,7 @@ void QueryModel<Result>::invalidateRow(int row)
 
   WModelIndex start = index(row, 0);
   WModelIndex end = index(row, columnCount() - 1);
-  dataChanged().emit(start, end);
+  notifyDataChanged(start, end);
 }
 
 template <class Result>
@@ -349,6 +567,10 @@ bool QueryModel<Result>::insertRows(int row, int count,
   }
 
   cachedRowCount_ += count;
+  if (estimatedRowCount_ >= 0)
+    estimatedRowCount_ += count;
+  if (resultsEnd_ != -1)
+    resultsEnd_ += count;
 
   endInsertRows();
 
@@ -367,6 +589,16 @@ bool QueryModel<Result>::removeRows(int row, int count,
   }
 
   cachedRowCount_ -= count;
+  if (estimatedRowCount_ >= 0)
+    estimatedRowCount_ -= count;
+  if (resultsEnd_ != -1)
+    resultsEnd_ -= count;
+
+  /*
+   * Keys of the following rows are no longer at the same position
+   */
+  keysetBoundaries_.erase(keysetBoundaries_.lower_bound(row),
+			  keysetBoundaries_.end());
 
   endRemoveRows();
 
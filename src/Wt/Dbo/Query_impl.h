@@ -7,6 +7,7 @@
 #ifndef WT_DBO_QUERY_IMPL_H_
 #define WT_DBO_QUERY_IMPL_H_
 
+#include <algorithm>
 #include <boost/tuple/tuple.hpp>
 
 #include <Wt/Dbo/Exception>
@@ -58,6 +59,9 @@ substituteFields(const SelectFieldList& list,
 		 std::string& sql,
 		 int offset);
 
+extern int WTDBO_API
+countParameters(const std::string& sql);
+
 extern void WTDBO_API 
 parseSql(const std::string& sql, SelectFieldLists& fieldLists,
 	 bool& simpleSelectCount);
@@ -336,7 +340,8 @@ template <class Result>
 Query<Result, DynamicBinding>::Query(Session& session, const std::string& sql)
   : Impl::QueryBase<Result>(session, sql),
     limit_(-1),
-    offset_(-1)
+    offset_(-1),
+    fetchSize_(-1)
 { }
 
 template <class Result>
@@ -345,7 +350,8 @@ Query<Result, DynamicBinding>::Query(Session& session,
 				     const std::string& where)
   : Impl::QueryBase<Result>(session, table, where),
     limit_(-1),
-    offset_(-1)
+    offset_(-1),
+    fetchSize_(-1)
 { }
 
 template <class Result>
@@ -356,7 +362,8 @@ Query<Result, DynamicBinding>
     groupBy_(other.groupBy_),
     orderBy_(other.orderBy_),
     limit_(other.limit_),
-    offset_(other.offset_)
+    offset_(other.offset_),
+    fetchSize_(other.fetchSize_)
 { 
   for (unsigned i = 0; i < other.parameters_.size(); ++i)
     parameters_.push_back(other.parameters_[i]->clone());
@@ -373,6 +380,7 @@ Query<Result, DynamicBinding>::operator=
   orderBy_ = other.orderBy_;
   limit_ = other.limit_;
   offset_ = other.offset_;
+  fetchSize_ = other.fetchSize_;
 
   reset();
 
@@ -460,6 +468,21 @@ int Query<Result, DynamicBinding>::limit() const
   return limit_;
 }
 
+template <class Result>
+Query<Result, DynamicBinding>&
+Query<Result, DynamicBinding>::fetchSize(int rows)
+{
+  fetchSize_ = rows;
+
+  return *this;
+}
+
+template <class Result>
+int Query<Result, DynamicBinding>::fetchSize() const
+{
+  return fetchSize_;
+}
+
 template <class Result>
 Result Query<Result, DynamicBinding>::resultValue() const
 {
@@ -482,6 +505,9 @@ collection<Result> Query<Result, DynamicBinding>::resultList() const
   bindParameters(statement);
   bindParameters(countStatement);
 
+  if (fetchSize_ > 0)
+    statement->setFetchSize(fetchSize_);
+
   return collection<Result>(this->session_, statement, countStatement);
 }
 
@@ -527,6 +553,24 @@ void Query<Result, DynamicBinding>::bindParameters(SqlStatement *statement)
   }
 }
 
+template <class Result>
+void Query<Result, DynamicBinding>::moveToWhere(int count)
+{
+  /*
+   * The parameters are bound in the order of the markers in the
+   * query: those of the select and where clause, followed by those
+   * of the group by and order by clauses.
+   */
+  int position = Impl::countParameters(this->sql_)
+    + Impl::countParameters(where_) - count;
+  int last = static_cast<int>(parameters_.size()) - count;
+
+  if (position >= 0 && position < last)
+    std::rotate(parameters_.begin() + position,
+		parameters_.begin() + last,
+		parameters_.end());
+}
+
 template <class Result>
 void Query<Result, DynamicBinding>::reset()
 {
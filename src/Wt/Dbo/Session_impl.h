@@ -7,7 +7,10 @@
 #ifndef WT_DBO_SESSION_IMPL_H_
 #define WT_DBO_SESSION_IMPL_H_
 
+#include <algorithm>
 #include <iostream>
+#include <memory>
+#include <boost/lexical_cast.hpp>
 
 #include <Wt/Dbo/SqlConnection>
 #include <Wt/Dbo/Query>
@@ -50,6 +53,11 @@ void Session::mapClass(const char *tableName)
 
   classRegistry_[&typeid(C)] = mapping;
   tableRegistry_[tableName] = mapping;
+
+  unsigned slot = Impl::allocateClassSlot(&Impl::ClassSlot<C>::index);
+  if (slot >= classSlots_.size())
+    classSlots_.resize(slot + 1);
+  classSlots_[slot] = mapping;
 }
 
 template <class C>
@@ -57,15 +65,14 @@ SqlStatement *Session::getStatement(int statementIdx)
 {
   initSchema();
 
-  ClassRegistry::iterator i = classRegistry_.find(&typeid(C));
-  MappingInfo *mapping = i->second;
+  MappingInfo *mapping = findMapping<C>();
 
   std::string id = statementId(mapping->tableName, statementIdx);
 
   SqlStatement *result = getStatement(id);
 
   if (!result)
-    result = prepareStatement(id, mapping->statements[statementIdx]);
+    result = prepareStatement(id, mapping->statements[statementIdx], true);
 
   return result;
 }
@@ -73,9 +80,9 @@ SqlStatement *Session::getStatement(int statementIdx)
 template <class C>
 const char *Session::tableName() const
 {
-  ClassRegistry::const_iterator i = classRegistry_.find(&typeid(C));
-  if (i != classRegistry_.end())
-    return dynamic_cast< Mapping<C> *>(i->second)->tableName;
+  Mapping<C> *mapping = findMapping<C>();
+  if (mapping)
+    return mapping->tableName;
   else
     throw Exception(std::string("Class ") + typeid(C).name()
 		    + " was not mapped.");
@@ -87,9 +94,8 @@ Session::Mapping<C> *Session::getMapping() const
   if (!schemaInitialized_)
     initSchema();
 
-  ClassRegistry::const_iterator i = classRegistry_.find(&typeid(C));
-  if (i != classRegistry_.end()) {
-    Session::Mapping<C> *mapping = dynamic_cast< Mapping<C> *>(i->second);
+  Mapping<C> *mapping = findMapping<C>();
+  if (mapping) {
     if (!mapping->initialized_)
       mapping->init(*const_cast<Session *>(this));
     return mapping;
@@ -98,6 +104,24 @@ Session::Mapping<C> *Session::getMapping() const
 		    + " was not mapped.");
 }
 
+template <class C>
+Session::Mapping<C> *Session::findMapping() const
+{
+  unsigned slot = Impl::ClassSlot<C>::index;
+  if (slot < classSlots_.size() && classSlots_[slot])
+    return static_cast< Mapping<C> *>(classSlots_[slot]);
+
+  /*
+   * The class may have been given a slot by another copy of the
+   * template, when mapped from a different shared library.
+   */
+  ClassRegistry::const_iterator i = classRegistry_.find(&typeid(C));
+  if (i != classRegistry_.end())
+    return dynamic_cast< Mapping<C> *>(i->second);
+  else
+    return 0;
+}
+
 template <class C>
 ptr<C> Session::load(SqlStatement *statement, int& column)
 {
@@ -122,9 +146,18 @@ ptr<C> Session::loadWithNaturalId(SqlStatement *statement, int& column)
     mapping->registry_[dbo->id()] = dbo;
     return ptr<C>(dbo);
   } else {
+    MetaDbo<C> *existing = i->second;
+
+    /* Complete an object that was referenced but not yet loaded */
+    if (!existing->obj_ && !existing->isDeleted()) {
+      existing->setObj(dbo->obj_);
+      existing->setVersion(dbo->version());
+      dbo->obj_ = 0;
+    }
+
     dbo->setSession(0);
     delete dbo;
-    return ptr<C>(i->second);
+    return ptr<C>(existing);
   }
 }
 
@@ -157,9 +190,15 @@ ptr<C> Session::loadWithLongLongId(SqlStatement *statement, int& column)
 
       return ptr<C>(dbo);
     } else {
-      column += (int)mapping->fields.size() + 1; // + version
+      MetaDbo<C> *dbo = i->second;
 
-      return ptr<C>(i->second);
+      /* Complete an object that was referenced but not yet loaded */
+      if (!dbo->obj_ && !dbo->isDeleted())
+	implLoad<C>(*dbo, statement, column);
+      else
+	column += (int)mapping->fields.size() + 1; // + version
+
+      return ptr<C>(dbo);
     }
   } else
     return loadWithNaturalId<C>(statement, column);
@@ -216,6 +255,52 @@ ptr<C> Session::loadLazy(const typename dbo_traits<C>::IdType& id)
     return ptr<C>(i->second);
 }
 
+template <class C>
+void Session::preload()
+{
+  Mapping<C> *mapping = getMapping<C>();
+
+  std::vector<MetaDbo<C> *> pending;
+
+  for (typename Mapping<C>::Registry::iterator i = mapping->registry_.begin();
+       i != mapping->registry_.end(); ++i) {
+    MetaDbo<C> *dbo = i->second;
+    if (!dbo->obj_ && !dbo->isDeleted())
+      pending.push_back(dbo);
+  }
+
+  int maxRows = maxPreloadRows(mapping);
+
+  for (unsigned i = 0; i < pending.size();) {
+    int rows = std::min((int)(pending.size() - i), maxRows);
+
+    int statementRows = 1;
+    while (statementRows < rows)
+      statementRows *= 2;
+
+    SqlStatement *statement = getPreloadStatement(mapping, statementRows);
+    ScopedStatementUse use(statement);
+
+    statement->reset();
+
+    /*
+     * The remaining parameters repeat the last id.
+     */
+    int column = 0;
+    for (int j = 0; j < statementRows; ++j)
+      pending[i + std::min(j, rows - 1)]->bindId(statement, column);
+
+    statement->execute();
+
+    while (statement->nextRow()) {
+      column = 0;
+      load<C>(statement, column);
+    }
+
+    i += rows;
+  }
+}
+
 template <class C, typename BindStrategy>
 Query< ptr<C>, BindStrategy > Session::find(const std::string& where)
 {
@@ -264,6 +349,116 @@ void Session::implSave(MetaDbo<C>& dbo)
   mapping->registry_[dbo.id()] = &dbo;
 }
 
+template<class C>
+void Session::implSaveBatch(const std::vector<MetaDboBase *>& objects)
+{
+  if (!transaction_)
+    throw Exception("Dbo save(): no active transaction");
+
+  Session::Mapping<C> *mapping = getMapping<C>();
+
+  /*
+   * (1) Dependencies, which may already save some of the objects
+   * themselves (when they refer to each other).
+   */
+  for (unsigned i = 0; i < objects.size(); ++i) {
+    MetaDbo<C> *dbo = static_cast<MetaDbo<C> *>(objects[i]);
+
+    if (dbo->isDirty()) {
+      SaveDbAction<C> action(*dbo, *mapping);
+      action.visitDependencies(*dbo->obj());
+    }
+  }
+
+  std::vector<MetaDbo<C> *> batch;
+  for (unsigned i = 0; i < objects.size(); ++i) {
+    MetaDbo<C> *dbo = static_cast<MetaDbo<C> *>(objects[i]);
+
+    if (dbo->isDirty() && !dbo->inTransaction()) {
+      dbo->state_ &= ~MetaDboBase::NeedsSave;
+      dbo->state_ |= MetaDboBase::Saving;
+
+      transaction_->objects_.push_back(new ptr<C>(dbo));
+      batch.push_back(dbo);
+    }
+  }
+
+  try {
+    /*
+     * (2) Self, in statements of at most maxRows rows, the remainder
+     * using statements for a power of two rows.
+     */
+    int maxRows = maxInsertBatchRows(mapping);
+
+    SqlStatement *single = 0;
+    ScopedStatementUse singleUse;
+
+    for (unsigned i = 0; i < batch.size();) {
+      int rows = std::min((int)(batch.size() - i), maxRows);
+      if (rows < maxRows) {
+	int r = 1;
+	while (r * 2 <= rows)
+	  r *= 2;
+	rows = r;
+      }
+
+      SqlStatement *statement;
+      ScopedStatementUse batchUse;
+
+      if (rows == 1) {
+	if (!single)
+	  singleUse(single = getStatement<C>(SqlInsert));
+	statement = single;
+      } else
+	batchUse(statement = getBatchInsertStatement(mapping, rows));
+
+      statement->reset();
+
+      int column = 0;
+      for (int j = 0; j < rows; ++j) {
+	SaveDbAction<C> action(*batch[i + j], *mapping);
+	action.bindInsert(*batch[i + j]->obj(), statement, column);
+      }
+
+      statement->execute();
+
+      if (mapping->surrogateIdFieldName) {
+	if (rows == 1)
+	  batch[i]->setAutogeneratedId(statement->insertedId());
+	else
+	  for (int j = 0; j < rows; ++j) {
+	    long long id;
+	    if (!statement->nextRow() || !statement->getResult(0, &id))
+	      throw Exception("Dbo save(): multi-row insert into "
+			      + std::string(mapping->tableName)
+			      + " did not return all ids");
+	    batch[i + j]->setAutogeneratedId(id);
+	  }
+      }
+
+      for (int j = 0; j < rows; ++j) {
+	MetaDbo<C> *dbo = batch[i + j];
+	dbo->setTransactionState(MetaDboBase::SavedInTransaction);
+	mapping->registry_[dbo->id()] = dbo;
+      }
+
+      i += rows;
+    }
+  } catch (...) {
+    for (unsigned i = 0; i < batch.size(); ++i)
+      batch[i]->setTransactionState(MetaDboBase::SavedInTransaction);
+    throw;
+  }
+
+  /*
+   * (3) Collections
+   */
+  for (unsigned i = 0; i < batch.size(); ++i) {
+    SaveDbAction<C> action(*batch[i], *mapping);
+    action.visitSets(*batch[i]->obj());
+  }
+}
+
 template<class C>
 void Session::implDelete(MetaDbo<C>& dbo)
 {
@@ -315,6 +510,59 @@ void Session::implLoad(MetaDbo<C>& dbo, SqlStatement *statement, int& column)
   if (!transaction_)
     throw Exception("Dbo load(): no active transaction");
 
+  if (getMapping<C>()->cachedTable)
+    implLoadCached(dbo, statement, column);
+  else
+    implLoadObject(dbo, statement, column);
+}
+
+template <class C>
+void Session::implLoadCached(MetaDbo<C>& dbo, SqlStatement *statement,
+			     int& column)
+{
+  Mapping<C> *mapping = getMapping<C>();
+
+  ScopedStatementUse use;
+
+  if (!statement) {
+    std::string id = boost::lexical_cast<std::string>(dbo.id());
+
+    std::auto_ptr<SqlStatement> cached(getCachedRow(mapping, id));
+    if (cached.get()) {
+      int c = 0;
+      implLoadObject(dbo, cached.get(), c);
+      return;
+    }
+
+    /*
+     * Select by id here rather than in LoadDbAction, so that the
+     * row can be recorded.
+     */
+    use(statement = getStatement<C>(SqlSelectById));
+    statement->reset();
+
+    column = 0;
+    dbo.bindId(statement, column);
+
+    statement->execute();
+
+    if (!statement->nextRow())
+      throw ObjectNotFoundException(id);
+
+    column = 0;
+  }
+
+  std::auto_ptr<SqlStatement> recorder(recordRow(statement, column));
+  implLoadObject(dbo, recorder.get(), column);
+
+  cacheRow(mapping, boost::lexical_cast<std::string>(dbo.id()),
+	   dbo.version(), recorder.release());
+}
+
+template <class C>
+void Session::implLoadObject(MetaDbo<C>& dbo, SqlStatement *statement,
+			     int& column)
+{
   LoadDbAction<C> action(dbo, *getMapping<C>(), statement, column);
 
   C *obj = new C();
@@ -327,6 +575,15 @@ void Session::implLoad(MetaDbo<C>& dbo, SqlStatement *statement, int& column)
   }
 }
 
+template <class C>
+void Session::uncache(MetaDbo<C>& dbo)
+{
+  Mapping<C> *mapping = getMapping<C>();
+
+  if (mapping->cachedTable)
+    uncacheRow(mapping, boost::lexical_cast<std::string>(dbo.id()));
+}
+
 template <class C>
 Session::Mapping<C>::~Mapping()
 {
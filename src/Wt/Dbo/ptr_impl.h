@@ -70,6 +70,14 @@ void MetaDbo<C>::flush()
   }
 }
 
+template <class C>
+void MetaDbo<C>::flushBatch(const std::vector<MetaDboBase *>& objects)
+{
+  checkNotOrphaned();
+
+  session()->template implSaveBatch<C>(objects);
+}
+
 template <class C>
 void MetaDbo<C>::bindId(SqlStatement *statement, int& column)
 {
@@ -153,6 +161,7 @@ void MetaDbo<C>::reread()
   checkNotOrphaned();
   if (isPersisted()) {
     session()->discardChanges(this);
+    session()->uncache(*this);
 
     delete obj_;
     obj_ = 0;
@@ -62,7 +62,7 @@ WT_DECLARE_WT_MEMBER
 	 if ($t.hasClass('Wt-selected'))
 	   selected = true;
 	 ele = t;
-	 t = t.parentNode;
+	 t = column(t);
 	 columnId = t.className.split(' ')[0].substring(7) * 1;
 	 break;
        }
@@ -87,6 +87,34 @@ WT_DECLARE_WT_MEMBER
      return -1;
    }
 
+   /*
+    * Items may be rendered in runs of rows, wrapped in a 'Wt-tv-run'
+    */
+   function column(item) {
+     var col = item.parentNode;
+
+     if ($(col).hasClass('Wt-tv-run'))
+       col = col.parentNode;
+
+     return col;
+   }
+
+   function items(col) {
+     var i, il, result = [], c = col.childNodes;
+
+     for (i = 0, il = c.length; i < il; ++i)
+       if ($(c[i]).hasClass('Wt-tv-run'))
+	 result = result.concat($.makeArray(c[i].childNodes));
+       else
+	 result.push(c[i]);
+
+     return result;
+   }
+
+   function rowIndexOf(item) {
+     return $.inArray(item, items(column(item)));
+   }
+
    function resizeColumn(header, delta) {
      var rtl = $(document.body).hasClass('Wt-rtl');
 
@@ -243,11 +271,11 @@ WT_DECLARE_WT_MEMBER
        if (!item.el)
 	 return;
 
-       var col = item.el.parentNode,
-           rowi = indexOf(item.el),
+       var col = column(item.el),
+           rowi = rowIndexOf(item.el),
            coli = indexOf(col),
            cols = col.parentNode.childNodes.length,
-           rows = col.childNodes.length,
+           rows = items(col).length,
 	   back = event.shiftKey,
 	   wrapped = false;
 
@@ -268,7 +296,7 @@ WT_DECLARE_WT_MEMBER
 	     if (i == rowi && j == coli)
 	       return;
 	     col = col.parentNode.childNodes[j];
-	     var elij = col.childNodes[i];
+	     var elij = items(col)[i];
 	     var inputs = $(elij).find(":input");
 	     if (inputs.size() > 0) {
 	       setTimeout(function() { inputs.focus(); }, 0);
@@ -292,11 +320,11 @@ WT_DECLARE_WT_MEMBER
        if (!item.el)
 	 return;
 
-       var col = item.el.parentNode,
-           rowi = indexOf(item.el),
+       var col = column(item.el),
+           rowi = rowIndexOf(item.el),
            coli = indexOf(col),
            cols = col.parentNode.childNodes.length,
-	   rows = col.childNodes.length;
+	   rows = items(col).length;
 
        switch (event.keyCode) {
 	 case rightKey:
@@ -327,7 +355,7 @@ WT_DECLARE_WT_MEMBER
 
        if (rowi > -1 && rowi < rows && coli > -1 && coli < cols) {
 	 col = col.parentNode.childNodes[coli];
-	 var elToSelect = col.childNodes[rowi];
+	 var elToSelect = items(col)[rowi];
 	 var inputs = $(elToSelect).find(":input");
 	 if (inputs.size() > 0) {
 	   setTimeout(function() { inputs.focus(); }, 0);
@@ -0,0 +1,115 @@
+// This may look like C code, but it's really -*- C++ -*-
+/*
+ * Copyright (C) 2012 Emweb bvba, Kessel-Lo, Belgium.
+ *
+ * See the LICENSE file for terms of use.
+ */
+#ifndef LOADTEST_LOAD_TEST_H_
+#define LOADTEST_LOAD_TEST_H_
+
+#include <string>
+#include <vector>
+
+#include <boost/regex.hpp>
+#include <boost/thread.hpp>
+
+#include "Wt/WIOService"
+
+namespace loadtest {
+
+class SimulatedSession;
+
+/*
+ * One recorded event, as the form-encoded event data posted by Wt.js
+ * (e.g. "signal=s2f" or "signal=user&id=o2b&name=keyup"), in which
+ * parts between {{ and }} are regular expressions. These are matched
+ * against the responses the session received so far, most recent
+ * first, and replaced by the first sub-expression of the match (or
+ * the entire match if there is none). This allows a recorded
+ * event to refer to object ids and signal names that differ in every
+ * session.
+ */
+class ScriptLine
+{
+public:
+  ScriptLine(const std::string& line);
+
+  std::string substitute(const std::vector<std::string>& responses) const;
+
+private:
+  std::vector<std::string> literals_;
+  std::vector<boost::regex> expressions_;
+};
+
+class LoadTest
+{
+public:
+  struct Options {
+    Options();
+
+    std::string url;
+    std::string scriptFile;
+    std::string userAgent;
+    int sessions;
+    int concurrency;
+    int threads;
+    int repeat;
+    int thinkTime;
+    int timeout;
+    int serverPid;
+  };
+
+  enum Phase { Bootstrap, Script, Load, Event, Push, PhaseCount };
+
+  LoadTest(const Options& options);
+  ~LoadTest();
+
+  /*
+   * Runs all sessions, and prints a report on std::cout. Returns
+   * false if any session failed.
+   */
+  bool run();
+
+  const Options& options() const { return options_; }
+  const std::vector<ScriptLine>& script() const { return script_; }
+  Wt::WIOService& ioService() { return ioService_; }
+
+  void addRequest(Phase phase, double milliSeconds, std::size_t bytes);
+  void sessionDone(bool ok, const std::string& error);
+
+private:
+  struct PhaseStats {
+    PhaseStats() : bytes(0) { }
+
+    std::vector<double> latencies;
+    std::size_t bytes;
+  };
+
+  struct ServerUsage {
+    ServerUsage() : cpuSeconds(0), rssKb(0) { }
+
+    double cpuSeconds;
+    long rssKb;
+  };
+
+  Options options_;
+  std::vector<ScriptLine> script_;
+  Wt::WIOService ioService_;
+
+  boost::mutex mutex_;
+  boost::condition_variable done_;
+  std::vector<SimulatedSession *> sessions_;
+  int started_, completed_, failed_;
+  PhaseStats stats_[PhaseCount];
+
+  void loadScript();
+  void startSession();
+  bool sampleServer(ServerUsage& usage) const;
+  void report(double seconds, bool haveServer,
+	      const ServerUsage& start, const ServerUsage& end,
+	      long peakRssKb);
+};
+
+}
+
+#endif // LOADTEST_LOAD_TEST_H_
@@ -0,0 +1,104 @@
+// This may look like C code, but it's really -*- C++ -*-
+/*
+ * Copyright (C) 2012 Emweb bvba, Kessel-Lo, Belgium.
+ *
+ * See the LICENSE file for terms of use.
+ */
+#ifndef LOADTEST_SIMULATED_SESSION_H_
+#define LOADTEST_SIMULATED_SESSION_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/system/error_code.hpp>
+#include <boost/thread.hpp>
+
+#include "Wt/Http/Message"
+
+#include "LoadTest.h"
+
+namespace Wt {
+  namespace Http {
+    class Client;
+  }
+}
+
+namespace loadtest {
+
+/*
+ * A single client session, which follows the protocol of Boot.js and
+ * Wt.js: it fetches the bootstrap page, loads the main script (which
+ * creates an Ajax session), and then posts the recorded events,
+ * keeping track of the ackId and pageId like Wt.js does.
+ *
+ * When the application enables server push, a long poll request is
+ * kept open while no event is pending. Posting an event makes the
+ * server complete the outstanding poll request, as in Wt.js.
+ *
+ * Cookies set by the server (e.g. the session id cookie, when the
+ * 'session-id-cookie' option is enabled) are sent with every later
+ * request.
+ *
+ * All requests use asynchronous I/O on the test's WIOService, so
+ * many sessions can be simulated by only a few threads.
+ */
+class SimulatedSession
+{
+public:
+  SimulatedSession(LoadTest& test);
+  ~SimulatedSession();
+
+  void start();
+
+private:
+  enum State { Bootstrapping, LoadingScript, Loading, Running, Finished };
+
+  LoadTest& test_;
+  boost::mutex mutex_;
+
+  State state_;
+  std::string sessionUrl_;
+  std::string ackId_, pageId_;
+  bool serverPush_;
+
+  std::size_t event_;
+  int iteration_;
+  std::vector<std::string> responses_;
+  std::map<std::string, std::string> cookies_;
+
+  Wt::Http::Client *client_;
+  bool eventPending_;
+  boost::posix_time::ptime requestStart_;
+
+  Wt::Http::Client *pollClient_;
+  bool pollPending_;
+  boost::posix_time::ptime pollStart_;
+
+  Wt::Http::Client *createClient(int timeout);
+  std::vector<Wt::Http::Message::Header> headers() const;
+
+  void get(const std::string& url);
+  void post(Wt::Http::Client *client, const std::string& data);
+
+  void handleResponse(boost::system::error_code err,
+		      Wt::Http::Message response);
+  void handlePoll(boost::system::error_code err,
+		  Wt::Http::Message response);
+
+  void storeCookies(const Wt::Http::Message& response);
+  bool handleBootstrap(const std::string& body);
+  void processUpdate(const std::string& body);
+
+  void scheduleEvent();
+  void sendEvent();
+  void startPoll();
+
+  void finish(const std::string& error);
+  double elapsed(const boost::posix_time::ptime& start) const;
+};
+
+}
+
+#endif // LOADTEST_SIMULATED_SESSION_H_
@@ -148,6 +148,7 @@ public:
   std::string redirectMessage() const;
   bool serializedEvents() const;
   bool webSockets() const;
+  bool compactUpdates() const;
   bool inlineCss() const;
   bool persistentSessions() const;
   bool progressiveBoot() const;
@@ -209,6 +210,7 @@ private:
   std::string     redirectMsg_;
   bool            serializedEvents_;
   bool		  webSockets_;
+  bool            compactUpdates_;
   bool            inlineCss_;
   AgentList       ajaxAgentList_, botList_;
   bool            ajaxAgentWhiteList_;
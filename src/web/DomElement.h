@@ -12,6 +12,7 @@
 #include <sstream>
 #include <string>
 
+#include "Wt/WInternedString"
 #include "Wt/WWebWidget"
 #include "EscapeOStream.h"
 
@@ -101,10 +102,11 @@ public:
   void insertChildAt(DomElement *child, int pos);
   void saveChild(const std::string& id);
 
-  void setAttribute(const std::string& attribute, const std::string& value);
+  void setAttribute(const WInternedString& attribute,
+		    const std::string& value);
 
-  std::string getAttribute(const std::string& attribute) const;
-  void removeAttribute(const std::string& attribute);
+  std::string getAttribute(const WInternedString& attribute) const;
+  void removeAttribute(const WInternedString& attribute);
 
   void setProperty(Wt::Property property, const std::string& value);
   std::string getProperty(Wt::Property property) const;
@@ -225,7 +227,8 @@ private:
       : jsCode(j), signalName(sn) { }
   };
 
-  typedef std::map<std::string, std::string> AttributeMap;
+  typedef std::map<WInternedString, std::string,
+		   WInternedString::LexicalLess> AttributeMap;
   typedef std::map<const char *, EventHandler> EventHandlerMap;
 
   bool canWriteInnerHTML(WApplication *app) const;
@@ -244,6 +247,8 @@ private:
 				 const std::string& parentVar, int pos,
 				 WApplication *app);
   void renderInnerHtmlJS(EscapeOStream& out, WApplication *app) const;
+  bool canRenderCompactJS() const;
+  void renderCompactJS(EscapeOStream& out, WApplication *app) const;
 
   Mode         mode_;
   bool         wasEmpty_;
@@ -26,6 +26,13 @@ namespace Wt {
  *  _$_$ifnot_condition_$_;
  *     ...
  *  _$_$endif_$_;
+ *
+ * A template is split into text, variable and condition segments only
+ * once, and the result is shared by all instances (across sessions)
+ * that serve the same template. The text segments are streamed
+ * directly from the template, which must therefore remain valid for
+ * the lifetime of the process: this is the case for the skeletons
+ * which are compiled into the library.
  */
 class FileServe
 {
@@ -41,9 +48,11 @@ public:
   void stream(std::ostream& out);
   void streamUntil(std::ostream& out, const std::string& until);
 
+  class Template;
+
 private:
-  const char *template_;
-  int currentPos_;
+  const Template *template_;
+  std::size_t currentPos_;
   std::map<std::string, std::string> vars_;
   std::map<std::string, bool> conditions_;
 };
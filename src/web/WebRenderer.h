@@ -42,10 +42,14 @@ public:
 
   bool visibleOnly() const { return visibleOnly_; }
   void setVisibleOnly(bool how) { visibleOnly_ = how; }
+  bool compactUpdates() const { return compactUpdates_; }
+  void setCompactUpdates(bool how) { compactUpdates_ = how; }
   void setRendered(bool how) { rendered_ = how; }
 
   void needUpdate(WWidget *w, bool laterOnly);
   void doneUpdate(WWidget *w);
+  void needDoneRerender(WWebWidget *w);
+  void cancelDoneRerender(WWebWidget *w);
   void updateFormObjects(WWebWidget *w, bool checkDescendants);
 
   void updateFormObjectsList(WApplication *app);
@@ -94,7 +98,7 @@ private:
 
   WebSession& session_;
 
-  bool visibleOnly_, rendered_;
+  bool visibleOnly_, rendered_, compactUpdates_;
   int twoPhaseThreshold_;
   unsigned pageId_, expectedAckId_, scriptId_;
   std::string solution_;
@@ -117,6 +121,7 @@ private:
   void collectJavaScript();
 
   void collectChanges(std::vector<DomElement *>& changes);
+  void doneRerender();
 
   void collectJavaScriptUpdate(std::ostream& out);
   void loadStyleSheets(std::ostream& out, WApplication *app);
@@ -146,6 +151,7 @@ private:
 
   typedef std::set<WWidget *> UpdateMap;
   UpdateMap updateMap_;
+  std::set<WWebWidget *> doneRerenderSet_;
   bool learning_, learningIncomplete_, moreUpdates_;
 
   std::string safeJsStringLiteral(const std::string& value);
@@ -154,6 +160,7 @@ public:
   std::string       learn(WStatelessSlot* slot);
 
   friend class WApplication;
+  friend class WebRendererTest;
 };
 
 }
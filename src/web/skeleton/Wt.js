@@ -1009,6 +1009,32 @@ this.inline = function(o) { WT.getElement(o).style.display = 'inline'; };
 this.block = function(o) { WT.getElement(o).style.display = 'block'; };
 this.show = function(o) { WT.getElement(o).style.display = ''; };
 
+/*
+ * Compact update: cu(id, op1, value1, op2, value2, ...), see
+ * DomElement::renderCompactJS()
+ */
+this.cu = function(id) {
+  var e = WT.getElement(id), i, il, op, v;
+  for (i = 1, il = arguments.length; i < il; i += 2) {
+    op = arguments[i];
+    v = arguments[i + 1];
+    switch (op) {
+    case 0: WT.setHtml(e, v, false); break;
+    case 1: WT.setHtml(e, v, true); break;
+    case 2: e.className = v; break;
+    case 3: e.value = v; break;
+    case 4: e.disabled = v; break;
+    case 5: e.checked = v; break;
+    case 6: e.readOnly = v; break;
+    default:
+      if (op.charAt(0) == '.')
+	e.style[op.substring(1)] = v;
+      else
+	e.setAttribute(op, v);
+    }
+  }
+};
+
 var captureElement = null;
 this.firedTarget = null;
 
@@ -43,7 +43,7 @@ b;a.selectionEnd=d}else if(document.selection){a=a.createTextRange();a.collapse(
 b,d){g.stopRepeat();b=b||500;d=d||50;a();U=setTimeout(function(){U=null;a();aa=setInterval(a,d)},b)};this.stopRepeat=function(){if(U){clearTimeout(U);U=null}if(aa){clearInterval(aa);aa=null}};var ha=null,V=null;this.css=function(a,b){if(a.style[b])return a.style[b];else{if(a!==ha){ha=a;V=window.getComputedStyle?window.getComputedStyle(a,null):a.currentStyle?a.currentStyle:null}return V?V[b]:null}};this.parsePx=function(a){return M(a,/^\s*(-?\d+(?:\.\d+)?)\s*px\s*$/i,0)};this.px=function(a,b){return g.parsePx(g.css(a,
 b))};this.pxself=function(a,b){return g.parsePx(a.style[b])};this.pctself=function(a,b){return E(a.style[b],0)};this.cssPrefix=function(a){var b=["Moz","Webkit"],d=document.createElement("div"),h,k;h=0;for(k=b.length;h<k;++h)if(b[h]+a in d.style)return b[h]};this.boxSizing=function(a){return(a.style.boxSizing||a.style.MozBoxSizing||a.style.WebkitBoxSizing)==="border-box"};this.isHidden=function(a){if(a.style.display=="none"||a.style.visibility=="hidden")return true;else return(a=a.parentNode)&&!g.hasTag(a,
 "BODY")?g.isHidden(a):false};this.innerWidth=function(a){var b=a.offsetWidth;g.boxSizing(a)||(b-=g.px(a,"paddingLeft")+g.px(a,"paddingRight")+g.px(a,"borderLeftWidth")+g.px(a,"borderRightWidth"));return b};this.innerHeight=function(a){var b=a.offsetHeight;g.boxSizing(a)||(b-=g.px(a,"paddingTop")+g.px(a,"paddingBottom")+g.px(a,"borderTopWidth")+g.px(a,"borderBottomWidth"));return b};this.IEwidth=function(a,b,d){if(a.parentNode){var h=a.parentNode.clientWidth-g.px(a,"marginLeft")-g.px(a,"marginRight")-
-g.px(a,"borderLeftWidth")-g.px(a,"borderRightWidth")-g.px(a.parentNode,"paddingLeft")-g.px(a.parentNode,"paddingRight");b=E(b,0);d=E(d,1E5);return h<b?b-1:h>d?d+1:a.style.styleFloat!=""?b-1:"auto"}else return"auto"};this.hide=function(a){g.getElement(a).style.display="none"};this.inline=function(a){g.getElement(a).style.display="inline"};this.block=function(a){g.getElement(a).style.display="block"};this.show=function(a){g.getElement(a).style.display=""};var J=null;this.firedTarget=null;this.target=
+g.px(a,"borderLeftWidth")-g.px(a,"borderRightWidth")-g.px(a.parentNode,"paddingLeft")-g.px(a.parentNode,"paddingRight");b=E(b,0);d=E(d,1E5);return h<b?b-1:h>d?d+1:a.style.styleFloat!=""?b-1:"auto"}else return"auto"};this.hide=function(a){g.getElement(a).style.display="none"};this.inline=function(a){g.getElement(a).style.display="inline"};this.block=function(a){g.getElement(a).style.display="block"};this.show=function(a){g.getElement(a).style.display=""};this.cu=function(a){var b=g.getElement(a),c,d,e,f;c=1;for(d=arguments.length;c<d;c+=2){e=arguments[c];f=arguments[c+1];switch(e){case 0:g.setHtml(b,f,false);break;case 1:g.setHtml(b,f,true);break;case 2:b.className=f;break;case 3:b.value=f;break;case 4:b.disabled=f;break;case 5:b.checked=f;break;case 6:b.readOnly=f;break;default:if(e.charAt(0)==".")b.style[e.substring(1)]=f;else b.setAttribute(e,f)}}};var J=null;this.firedTarget=null;this.target=
 function(a){return g.firedTarget||a.target||a.srcElement};var da=false;this.capture=function(a){ka();if(!(J&&a)){J=a;var b=document.body;document.body.addEventListener||(a!=null?b.setCapture():b.releaseCapture());if(a!=null){$(b).addClass("unselectable");b.setAttribute("unselectable","on");b.onselectstart="return false;"}else{$(b).removeClass("unselectable");b.setAttribute("unselectable","off");b.onselectstart=""}}};this.checkReleaseCapture=function(a,b){b&&J&&a==J&&b.type=="mouseup"&&this.capture(null)};
 this.getElementsByClassName=function(a,b){if(document.getElementsByClassName)return b.getElementsByClassName(a);else{b=b.getElementsByTagName("*");for(var d=[],h,k=0,l=b.length;k<l;k++){h=b[k];h.className.indexOf(a)!=-1&&d.push(h)}return d}};var S=null;this.addCss=function(a,b){var d=ea();d.insertRule(a+" { "+b+" }",d.cssRules?d.cssRules.length:0)};this.addCssText=function(a){var b=document.getElementById("Wt-inline-css");if(!b){b=document.createElement("style");b.id="Wt-inline-css";document.getElementsByTagName("head")[0].appendChild(b)}if(b.styleSheet){var d=
 b.previousSibling;if(!d||!g.hasTag(d,"STYLE")||d.styleSheet.cssText.length>32768){d=document.createElement("style");b.parentNode.insertBefore(d,b);d.styleSheet.cssText=a}else d.styleSheet.cssText+=a}else{a=document.createTextNode(a);b.appendChild(a)}};this.getCssRule=function(a,b){a=a.toLowerCase();if(document.styleSheets)for(var d=0;d<document.styleSheets.length;d++){var h=document.styleSheets[d],k=0,l;do{l=null;try{if(h.cssRules)l=h.cssRules[k];else if(h.rules)l=h.rules[k];if(l&&l.selectorText)if(l.selectorText.toLowerCase()==
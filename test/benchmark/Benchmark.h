@@ -0,0 +1,60 @@
+// This may look like C code, but it's really -*- C++ -*-
+/*
+ * Copyright (C) 2012 Emweb bvba, Kessel-Lo, Belgium.
+ *
+ * See the LICENSE file for terms of use.
+ */
+#ifndef WT_TEST_BENCHMARK_H_
+#define WT_TEST_BENCHMARK_H_
+
+#include <cstdlib>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+/*
+ * mallinfo() is specific to glibc, and was replaced by mallinfo2()
+ * in glibc 2.33.
+ */
+#if defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+#include <malloc.h>
+#if __GLIBC_PREREQ(2, 33)
+#define WT_TEST_MALLINFO2
+#else
+#define WT_TEST_MALLINFO
+#endif
+#endif
+
+namespace Benchmark {
+
+/*
+ * Returns the number of bytes allocated on the heap, or -1 if this is
+ * not known.
+ */
+inline long heapBytes()
+{
+#if defined(WT_TEST_MALLINFO2)
+  struct mallinfo2 info = mallinfo2();
+  return info.uordblks + info.hblkhd;
+#elif defined(WT_TEST_MALLINFO)
+  struct mallinfo info = mallinfo();
+  return info.uordblks + info.hblkhd;
+#else
+  return -1;
+#endif
+}
+
+inline boost::posix_time::ptime now()
+{
+  return boost::posix_time::microsec_clock::local_time();
+}
+
+/*
+ * Returns the time in ms since start.
+ */
+inline double elapsedMs(const boost::posix_time::ptime& start)
+{
+  return (double)(now() - start).total_microseconds() / 1000;
+}
+
+}
+
+#endif // WT_TEST_BENCHMARK_H_